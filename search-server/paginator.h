@@ -1,7 +1,10 @@
 #pragma once
-#include <vector>
 #include <iostream>
 #include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 
 template <class Iterator>
 class Page
@@ -23,7 +26,7 @@ public:
 
     inline size_t size() const
     {
-        return distance(begin_, end_);
+        return std::distance(begin_, end_);
     }
 
 private:
@@ -40,38 +43,113 @@ std::ostream& operator<<(std::ostream& out, const Page<Iterator> page)
     return out;
 }
 
+// Advances it by at most n steps without passing end
+template <class Iterator>
+Iterator AdvanceBounded(Iterator it, Iterator end, size_t n)
+{
+    using Category = typename std::iterator_traits<Iterator>::iterator_category;
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag, Category>)
+        return it + std::min(n, static_cast<size_t>(end - it));
+    else
+    {
+        for (; n > 0 && it != end; --n)
+            ++it;
+        return it;
+    }
+}
+
+// A lazy view over the pages of a range, no page is stored.
+// Random access iterators give O(1) size() and operator[],
+// other iterators walk the range on demand.
 template <class Iterator>
 class Paginator
 {
 public:
-    Paginator(Iterator begin, Iterator end, size_t page_size)
+    class PageIterator
     {
-        auto it = begin;
-        while (it != end)
+    public:
+        // Pages are produced by value, so the iterator is single-pass by the standard's rules
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Page<Iterator>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Page<Iterator>;
+
+        PageIterator(Iterator begin, Iterator end, size_t page_size)
+            : begin_(begin), page_end_(AdvanceBounded(begin, end, page_size)), end_(end), page_size_(page_size)
+        {}
+
+        inline Page<Iterator> operator*() const
+        {
+            return { begin_, page_end_ };
+        }
+
+        PageIterator& operator++()
+        {
+            begin_ = page_end_;
+            page_end_ = AdvanceBounded(begin_, end_, page_size_);
+            return *this;
+        }
+
+        PageIterator operator++(int)
         {
-            auto offset = std::min(page_size, static_cast<size_t>(distance(it, end)));
-            advance(it, offset);
-            pages_.push_back({ begin, it });
-            begin = it;
+            auto copy = *this;
+            ++*this;
+            return copy;
         }
+
+        inline bool operator==(const PageIterator& other) const
+        {
+            return begin_ == other.begin_;
+        }
+
+        inline bool operator!=(const PageIterator& other) const
+        {
+            return !(*this == other);
+        }
+    private:
+        Iterator begin_;
+        Iterator page_end_;
+        Iterator end_;
+        size_t page_size_;
+    };
+
+    Paginator(Iterator begin, Iterator end, size_t page_size)
+        : begin_(begin), end_(end), page_size_(page_size)
+    {
+        if (page_size_ == 0)
+            throw std::invalid_argument("Page size must be positive");
     }
 
-    inline auto begin() const
+    inline PageIterator begin() const
     {
-        return pages_.begin();
+        return { begin_, end_, page_size_ };
     }
 
-    inline auto end() const
+    inline PageIterator end() const
     {
-        return pages_.end();
+        return { end_, end_, page_size_ };
     }
 
     inline size_t size() const
     {
-        return pages_.size();
+        const auto item_count = static_cast<size_t>(std::distance(begin_, end_));
+        return (item_count + page_size_ - 1) / page_size_;
+    }
+
+    // Page past the end of the range is empty
+    Page<Iterator> operator[](size_t index) const
+    {
+        if (index > std::numeric_limits<size_t>::max() / page_size_)
+            return { end_, end_ };
+
+        const auto page_begin = AdvanceBounded(begin_, end_, index * page_size_);
+        return { page_begin, AdvanceBounded(page_begin, end_, page_size_) };
     }
 private:
-    std::vector<Page<Iterator>> pages_;
+    Iterator begin_;
+    Iterator end_;
+    size_t page_size_;
 };
 
 template <class Container>
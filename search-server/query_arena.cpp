@@ -0,0 +1,97 @@
+#include "query_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace
+{
+    const size_t INITIAL_ARENA_SIZE = 64 * 1024;
+
+    // Remembers how much the arena overflowed its buffer during a query
+    class OverflowResource : public std::pmr::memory_resource
+    {
+    public:
+        inline size_t GetAllocatedBytes() const
+        {
+            return allocated_bytes_;
+        }
+
+        inline void ResetAllocatedBytes()
+        {
+            allocated_bytes_ = 0;
+        }
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            allocated_bytes_ += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    private:
+        size_t allocated_bytes_ = 0;
+    };
+
+    struct ThreadArena
+    {
+        std::unique_ptr<std::byte[]> buffer;
+        size_t size = 0;
+        OverflowResource overflow;
+        std::optional<std::pmr::monotonic_buffer_resource> resource;
+        int depth = 0;
+
+        void Reset()
+        {
+            // Frees the overflow chunks of the finished query
+            resource.reset();
+
+            // The buffer is capped so that one outlier query does not pin its memory to the thread
+            const auto new_size = buffer
+                ? std::min(size + overflow.GetAllocatedBytes(), QueryArena::MAX_RETAINED_SIZE)
+                : INITIAL_ARENA_SIZE;
+            overflow.ResetAllocatedBytes();
+
+            if (new_size != size)
+            {
+                size = new_size;
+                buffer.reset(new std::byte[size]);
+            }
+
+            resource.emplace(buffer.get(), size, &overflow);
+        }
+    };
+
+    ThreadArena& GetThreadArena()
+    {
+        thread_local ThreadArena arena;
+        return arena;
+    }
+}
+
+QueryArena::QueryArena()
+{
+    auto& arena = GetThreadArena();
+    if (!arena.resource)
+        arena.Reset();
+
+    ++arena.depth;
+    resource_ = &*arena.resource;
+}
+
+QueryArena::~QueryArena()
+{
+    // Only the outermost query owns the arena, e.g. a predicate may run another search
+    auto& arena = GetThreadArena();
+    if (--arena.depth == 0)
+        arena.Reset();
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+// Per-thread scratch memory for a single query.
+// Nested scopes share the arena, the end of the outermost one resets it.
+// The arena buffer grows to the largest query seen on the thread, up to
+// MAX_RETAINED_SIZE, so once warmed up a query that fits never reaches the
+// global allocator. Larger queries allocate their overflow on every run.
+class QueryArena
+{
+public:
+    inline static constexpr size_t MAX_RETAINED_SIZE = 8 * 1024 * 1024;
+
+    QueryArena();
+    ~QueryArena();
+
+    QueryArena(const QueryArena&) = delete;
+    QueryArena& operator=(const QueryArena&) = delete;
+
+    inline std::pmr::memory_resource* Resource() const
+    {
+        return resource_;
+    }
+private:
+    std::pmr::memory_resource* resource_;
+};
@@ -1,6 +1,11 @@
 #pragma once
 #include "search_server.h"
+#include "sharded_search_server.h"
 
 void RemoveDuplicates(SearchServer& search_server);
 
-std::vector<int> FindDuplicates(SearchServer& search_server);
\ No newline at end of file
+std::vector<int> FindDuplicates(SearchServer& search_server);
+
+void RemoveDuplicates(ShardedSearchServer& search_server);
+
+std::vector<int> FindDuplicates(ShardedSearchServer& search_server);
\ No newline at end of file
@@ -1,46 +1,185 @@
 #include "request_queue.h"
 
-#include <numeric>
+#include <stdexcept>
 
 RequestQueue::RequestQueue(const SearchServer& search_server)
-    : search_server_(search_server), current_min_(0), zero_result_count_(0)
+    : RequestQueue(search_server, std::chrono::hours(24), default_bucket_count_)
 {
 }
 
+RequestQueue::RequestQueue(const SearchServer& search_server, Clock::duration window, size_t bucket_count)
+    : search_server_(search_server), start_(Clock::now()),
+    bucket_width_(bucket_count ? window / static_cast<Clock::rep>(bucket_count) : Clock::duration::zero()),
+    buckets_(bucket_count), head_slot_(0)
+{
+    if (bucket_width_ <= Clock::duration::zero())
+        throw std::invalid_argument("Request window must be longer than its bucket count of clock ticks");
+}
+
 std::vector<Document> RequestQueue::AddFindRequest(const std::string& raw_query, DocumentStatus status)
 {
+    const auto start = Clock::now();
     auto result = search_server_.FindTopDocuments(raw_query, status);
-    QueueResult(result.size());
+    QueueResult(start, result.size());
     return result;
 }
 
 std::vector<Document> RequestQueue::AddFindRequest(const std::string& raw_query)
 {
+    const auto start = Clock::now();
     auto result = search_server_.FindTopDocuments(raw_query);
-    QueueResult(result.size());
+    QueueResult(start, result.size());
     return result;
 }
 
 int RequestQueue::GetNoResultRequests() const
 {
-    return std::accumulate(requests_.begin(), requests_.end(), 0,
-        [](int count, const QueryResult& result)
-        {
-            return count += result.match_count == 0;
-        });
+    AdvanceTo(GetSlot(Clock::now()));
+    return static_cast<int>(std::max<int64_t>(totals_.no_result.load(std::memory_order_relaxed), 0));
+}
+
+int RequestQueue::GetRequestCount() const
+{
+    AdvanceTo(GetSlot(Clock::now()));
+    return static_cast<int>(std::max<int64_t>(totals_.requests.load(std::memory_order_relaxed), 0));
+}
+
+double RequestQueue::GetAverageResultCount() const
+{
+    AdvanceTo(GetSlot(Clock::now()));
+    const auto requests = totals_.requests.load(std::memory_order_relaxed);
+    if (requests <= 0)
+        return 0.0;
+
+    return std::max<int64_t>(totals_.results.load(std::memory_order_relaxed), 0) * 1.0 / requests;
+}
+
+std::chrono::microseconds RequestQueue::GetLatencyPercentile(double percentile) const
+{
+    AdvanceTo(GetSlot(Clock::now()));
+
+    std::array<int64_t, LATENCY_BIN_COUNT> bins;
+    int64_t total = 0;
+    for (size_t i = 0; i < LATENCY_BIN_COUNT; ++i)
+    {
+        bins[i] = std::max<int64_t>(totals_.latency[i].load(std::memory_order_relaxed), 0);
+        total += bins[i];
+    }
+
+    if (total == 0)
+        return std::chrono::microseconds::zero();
+
+    const double rank = std::clamp(percentile, 0.0, 1.0) * total;
+    int64_t seen = 0;
+    for (size_t i = 0; i < LATENCY_BIN_COUNT; ++i)
+    {
+        seen += bins[i];
+        if (seen > 0 && seen >= rank)
+            return std::chrono::microseconds(GetLatencyBinUpperBound(i));
+    }
+
+    return std::chrono::microseconds::max();
+}
+
+void RequestQueue::QueueResult(Clock::time_point start, size_t result_count)
+{
+    const auto now = Clock::now();
+    const auto slot = GetSlot(now);
+    AdvanceTo(slot);
+
+    auto& bucket = buckets_[slot % buckets_.size()];
+    // The bucket was already reused by a newer slot, the request is out of the window
+    if (bucket.slot.load(std::memory_order_acquire) != slot)
+        return;
+
+    const size_t bin = GetLatencyBin(now - start);
+    AddRequest(bucket, result_count, bin);
+    AddRequest(totals_, result_count, bin);
 }
 
-void RequestQueue::QueueResult(size_t match_count)
+template <class Counter>
+void RequestQueue::AddRequest(Counters<Counter>& counters, size_t result_count, size_t latency_bin)
 {
-    ++current_min_;
+    counters.requests.fetch_add(1, std::memory_order_relaxed);
+    counters.no_result.fetch_add(result_count == 0, std::memory_order_relaxed);
+    counters.results.fetch_add(static_cast<Counter>(result_count), std::memory_order_relaxed);
+    counters.latency[latency_bin].fetch_add(1, std::memory_order_relaxed);
+}
 
-    if (current_min_ > min_in_day_)
+int64_t RequestQueue::GetSlot(Clock::time_point time) const
+{
+    return (time - start_) / bucket_width_;
+}
+
+void RequestQueue::AdvanceTo(int64_t slot) const
+{
+    auto head = head_slot_.load(std::memory_order_acquire);
+    while (head < slot)
     {
-        zero_result_count_ -= requests_.front().match_count == 0;
-        requests_.pop_front();
+        if (head_slot_.compare_exchange_weak(head, slot, std::memory_order_acq_rel))
+        {
+            // Buckets older than the window are reset at most once per slot
+            const auto bucket_count = static_cast<int64_t>(buckets_.size());
+            for (auto expired = std::max(head + 1, slot - bucket_count + 1); expired <= slot; ++expired)
+                ResetBucket(expired);
+            break;
+        }
     }
 
-    requests_.push_back({ match_count });
+    // The very first slot and slots raced past by another writer
+    if (buckets_[slot % buckets_.size()].slot.load(std::memory_order_acquire) < slot)
+        ResetBucket(slot);
+}
+
+void RequestQueue::ResetBucket(int64_t slot) const
+{
+    auto& bucket = buckets_[slot % buckets_.size()];
+    auto old_slot = bucket.slot.load(std::memory_order_acquire);
+    while (old_slot < slot)
+    {
+        if (!bucket.slot.compare_exchange_weak(old_slot, slot, std::memory_order_acq_rel))
+            continue;
 
-    zero_result_count_ += match_count == 0;
-}
\ No newline at end of file
+        totals_.requests.fetch_sub(bucket.requests.exchange(0), std::memory_order_relaxed);
+        totals_.no_result.fetch_sub(bucket.no_result.exchange(0), std::memory_order_relaxed);
+        totals_.results.fetch_sub(bucket.results.exchange(0), std::memory_order_relaxed);
+        // Most bins of a bucket stay empty, an increment racing with the check already belongs to the new slot
+        for (size_t i = 0; i < LATENCY_BIN_COUNT; ++i)
+            if (bucket.latency[i].load(std::memory_order_relaxed) != 0)
+                totals_.latency[i].fetch_sub(bucket.latency[i].exchange(0), std::memory_order_relaxed);
+        break;
+    }
+}
+
+size_t RequestQueue::GetLatencyBin(Clock::duration latency)
+{
+    auto micros = static_cast<uint64_t>(std::max<int64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(latency).count(), 0));
+
+    if (micros < LATENCY_SUB_BIN_COUNT)
+        return static_cast<size_t>(micros);
+
+    size_t exponent = 0;
+    while (micros >> (exponent + 1))
+        ++exponent;
+
+    if (exponent >= MAX_LATENCY_BITS)
+        return LATENCY_BIN_COUNT - 1;
+
+    // Leading bit plus the next LATENCY_SUB_BIN_BITS bits select the sub-bin
+    const auto shift = exponent - LATENCY_SUB_BIN_BITS;
+    const auto sub_bin = static_cast<size_t>(micros >> shift) - LATENCY_SUB_BIN_COUNT;
+    return LATENCY_SUB_BIN_COUNT * (shift + 1) + sub_bin;
+}
+
+int64_t RequestQueue::GetLatencyBinUpperBound(size_t bin)
+{
+    if (bin < LATENCY_SUB_BIN_COUNT)
+        return static_cast<int64_t>(bin);
+    if (bin + 1 >= LATENCY_BIN_COUNT)
+        return std::chrono::microseconds::max().count();
+
+    const auto shift = bin / LATENCY_SUB_BIN_COUNT - 1;
+    const auto sub_bin = bin % LATENCY_SUB_BIN_COUNT;
+    return static_cast<int64_t>(((LATENCY_SUB_BIN_COUNT + sub_bin + 1) << shift) - 1);
+}
@@ -1,12 +1,24 @@
 #pragma once
 #include "search_server.h"
 
-#include <deque>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
 
+// Sliding-window statistics of the search requests.
+// The window is split into time buckets kept in a ring buffer, running totals
+// are updated on write and expired buckets are subtracted, so every getter is O(1).
+// Writers and readers never lock; a request racing with the rotation of its own
+// bucket may be dropped from the statistics.
 class RequestQueue 
 {
 public:
+    using Clock = std::chrono::steady_clock;
+
     explicit RequestQueue(const SearchServer& search_server);
+    RequestQueue(const SearchServer& search_server, Clock::duration window, size_t bucket_count);
 
     std::vector<Document> AddFindRequest(const std::string& raw_query, DocumentStatus status);
     std::vector<Document> AddFindRequest(const std::string& raw_query);
@@ -14,25 +26,76 @@ public:
     template <class Predicate>
     std::vector<Document> AddFindRequest(const std::string& raw_query, Predicate document_predicate)
     {
+        const auto start = Clock::now();
         auto result = search_server_.FindTopDocuments(raw_query, document_predicate);
-        QueueResult(result);
+        QueueResult(start, result.size());
         return result;
     }
 
     int GetNoResultRequests() const;
+    int GetRequestCount() const;
+
+    // Returned documents per request, at most MAX_RESULT_DOCUMENT_COUNT
+    double GetAverageResultCount() const;
+
+    // Upper bound of the latency histogram bin, percentile is in [0, 1].
+    // Latencies below 8 us are exact, longer ones are overstated by less than 12.5%,
+    // latencies of 2^27 us (about two minutes) and longer are reported as microseconds::max()
+    std::chrono::microseconds GetLatencyPercentile(double percentile) const;
+
+    inline std::chrono::microseconds GetMedianLatency() const
+    {
+        return GetLatencyPercentile(0.5);
+    }
+
+    inline std::chrono::microseconds GetP99Latency() const
+    {
+        return GetLatencyPercentile(0.99);
+    }
+
+    // Each power of two of microseconds is split into linear sub-bins,
+    // the last bin collects latencies beyond the histogram range
+    static constexpr size_t LATENCY_SUB_BIN_BITS = 3;
+    static constexpr size_t LATENCY_SUB_BIN_COUNT = size_t{ 1 } << LATENCY_SUB_BIN_BITS;
+    static constexpr size_t MAX_LATENCY_BITS = 27;
+    static constexpr size_t LATENCY_BIN_COUNT = LATENCY_SUB_BIN_COUNT * (MAX_LATENCY_BITS - LATENCY_SUB_BIN_BITS + 1) + 1;
+
+    static size_t GetLatencyBin(Clock::duration latency);
+    static int64_t GetLatencyBinUpperBound(size_t bin);
 private:
-    void QueueResult(size_t match_count);
-private:
-    struct QueryResult
+    template <class Counter>
+    struct Counters
+    {
+        std::atomic<Counter> requests{};
+        std::atomic<Counter> no_result{};
+        std::atomic<Counter> results{};
+        std::array<std::atomic<Counter>, LATENCY_BIN_COUNT> latency{};
+    };
+
+    // Bucket counters are 32-bit, a bucket must hold fewer than 2^32 / MAX_RESULT_DOCUMENT_COUNT requests
+    struct Bucket : Counters<uint32_t>
     {
-        size_t match_count;
+        // Index of the time slot the bucket currently holds
+        std::atomic<int64_t> slot{ -1 };
     };
-    std::deque<QueryResult> requests_;
 
+    void QueueResult(Clock::time_point start, size_t result_count);
+
+    template <class Counter>
+    static void AddRequest(Counters<Counter>& counters, size_t result_count, size_t latency_bin);
+
+    int64_t GetSlot(Clock::time_point time) const;
+    void AdvanceTo(int64_t slot) const;
+    void ResetBucket(int64_t slot) const;
+private:
     const SearchServer& search_server_;
-    
-    uint32_t current_min_;
-    int zero_result_count_;
-    const static int min_in_day_ = 1440;
 
-};
\ No newline at end of file
+    const Clock::time_point start_;
+    const Clock::duration bucket_width_;
+
+    mutable std::vector<Bucket> buckets_;
+    mutable Counters<int64_t> totals_;
+    mutable std::atomic<int64_t> head_slot_;
+
+    inline static constexpr size_t default_bucket_count_ = 1440;
+};
@@ -41,24 +41,51 @@ std::vector<Document> SearchServer::FindTopDocuments(const std::string& raw_quer
     return FindTopDocuments(raw_query, DocumentStatus::ACTUAL);
 }
 
+std::vector<Document> SearchServer::FindDocumentsPage(const std::string& raw_query, DocumentStatus status, size_t page, size_t page_size) const
+{
+    return FindDocumentsPage(raw_query,
+        [status]([[maybe_unused]] int id, [[maybe_unused]] DocumentStatus status_to_compare, [[maybe_unused]] int rating)
+        {
+            return status == status_to_compare;
+        }, page, page_size);
+}
+
+std::vector<Document> SearchServer::FindDocumentsPage(const std::string& raw_query, size_t page, size_t page_size) const
+{
+    return FindDocumentsPage(raw_query, DocumentStatus::ACTUAL, page, page_size);
+}
+
+bool SearchServer::CompareByRelevance(const Document& lhs, const Document& rhs)
+{
+    // Ties are broken by id so that separately selected pages partition the result
+    if (std::abs(lhs.relevance - rhs.relevance) >= EPSILON)
+        return lhs.relevance > rhs.relevance;
+    if (lhs.rating != rhs.rating)
+        return lhs.rating > rhs.rating;
+    return lhs.id < rhs.id;
+}
+
 std::tuple<std::vector<std::string>, DocumentStatus> SearchServer::MatchDocument(const std::string& raw_query, int document_id) const
 {
-    Query query = ParseQuery(raw_query);
+    QueryArena arena;
+    Query query = ParseQuery(raw_query, arena.Resource());
 
     std::vector<std::string> matched_words;
-    for (const std::string& word : query.plus_words)
+    for (const std::string_view word : query.plus_words)
     {
-        if (word_to_document_freqs_.count(word) == 0)
+        const auto word_freqs = word_to_document_freqs_.find(word);
+        if (word_freqs == word_to_document_freqs_.end())
             continue;
-        if (word_to_document_freqs_.at(word).count(document_id))
-            matched_words.push_back(word);
+        if (word_freqs->second.count(document_id))
+            matched_words.emplace_back(word);
     }
-    for (const std::string& word : query.minus_words)
+    for (const std::string_view word : query.minus_words)
     {
-        if (word_to_document_freqs_.count(word) == 0)
+        const auto word_freqs = word_to_document_freqs_.find(word);
+        if (word_freqs == word_to_document_freqs_.end())
             continue;
 
-        if (word_to_document_freqs_.at(word).count(document_id))
+        if (word_freqs->second.count(document_id))
         {
             matched_words.clear();
             break;
@@ -87,7 +114,7 @@ int SearchServer::ComputeAverageRating(const std::vector<int>& ratings)
     return rating_sum / static_cast<int>(ratings.size());
 }
 
-SearchServer::QueryWord SearchServer::ParseQueryWord(std::string text) const
+SearchServer::QueryWord SearchServer::ParseQueryWord(std::string_view text) const
 {
     bool is_minus = false;
     // Word shouldn't be empty
@@ -95,7 +122,7 @@ SearchServer::QueryWord SearchServer::ParseQueryWord(std::string text) const
     if (text[0] == '-')
     {
         is_minus = true;
-        text = text.substr(1);
+        text.remove_prefix(1);
 
         if (text.empty() || text[0] == '-')
             throw std::invalid_argument("Minus word is empty or has extra minus sign");
@@ -107,10 +134,10 @@ SearchServer::QueryWord SearchServer::ParseQueryWord(std::string text) const
     return { text, is_minus, IsStopWord(text) };
 }
 
-SearchServer::Query SearchServer::ParseQuery(const std::string& text) const
+SearchServer::Query SearchServer::ParseQuery(std::string_view text, std::pmr::memory_resource* resource) const
 {
-    Query query;
-    for (const std::string& word : SplitIntoWords(text))
+    Query query(resource);
+    for (const std::string_view word : SplitIntoWords(text, resource))
     {
         QueryWord query_word = ParseQueryWord(word);
 
@@ -125,6 +152,22 @@ SearchServer::Query SearchServer::ParseQuery(const std::string& text) const
     return query;
 }
 
+void SearchServer::SelectTopDocuments(std::pmr::vector<Document>& documents, size_t offset, size_t count)
+{
+    if (offset >= documents.size())
+    {
+        documents.clear();
+        return;
+    }
+
+    // Only the documents up to the end of the requested range get ordered
+    const auto last = documents.begin() + std::min(documents.size() - offset, count) + offset;
+    std::partial_sort(documents.begin(), last, documents.end(), CompareByRelevance);
+
+    documents.erase(last, documents.end());
+    documents.erase(documents.begin(), documents.begin() + offset);
+}
+
 const std::map<std::string, double>& SearchServer::GetWordFrequencies(int document_id) const
 {
     if (id_to_word_freqs_.count(document_id))
@@ -135,9 +178,9 @@ const std::map<std::string, double>& SearchServer::GetWordFrequencies(int docume
     return dummy;
 }
 
-double SearchServer::ComputeWordInverseDocumentFreq(const std::string& word) const
+double SearchServer::ComputeWordInverseDocumentFreq(int document_count, size_t word_document_count)
 {
-    return std::log(GetDocumentCount() * 1.0 / word_to_document_freqs_.at(word).size());
+    return std::log(document_count * 1.0 / word_document_count);
 }
 
 void SearchServer::RemoveDocument(int document_id)
@@ -155,7 +198,7 @@ void SearchServer::RemoveDocument(int document_id)
     id_to_word_freqs_.erase(document_id);
 }
 
-bool SearchServer::IsValidWord(const std::string& word)
+bool SearchServer::IsValidWord(std::string_view word)
 {
     // A valid word must not contain special characters
     return std::none_of(word.begin(), word.end(),
@@ -2,19 +2,45 @@
 
 #include "document.h"
 #include "string_processing.h"
+#include "query_arena.h"
 
 #include <map>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <memory_resource>
 
 const int MAX_RESULT_DOCUMENT_COUNT = 5;
 const double EPSILON = 1e-6;
 
+// Corpus-wide document counts of the query plus words, in the order of SearchServer::Query::plus_words.
+// Lets several servers rank with the same IDF
+struct CorpusStatistics
+{
+    explicit CorpusStatistics(std::pmr::memory_resource* resource)
+        : word_document_count(resource)
+    {}
+
+    int document_count = 0;
+    std::pmr::vector<int> word_document_count;
+};
+
 class SearchServer
 {
 public:
     inline static constexpr int INVALID_DOCUMENT_ID = -1;
 
+    // Words are views into the raw query text
+    struct Query
+    {
+        explicit Query(std::pmr::memory_resource* resource)
+            : plus_words(resource), minus_words(resource)
+        {}
+
+        std::pmr::set<std::string_view> plus_words;
+        std::pmr::set<std::string_view> minus_words;
+    };
+
     explicit SearchServer(const std::string& stop_words_text);
 
     template <class StringContainer>
@@ -27,7 +53,29 @@ public:
     template <class Predicate>
     std::vector<Document> FindTopDocuments(const std::string& raw_query, Predicate predicate) const;
 
+    // All intermediate containers of the query are allocated from resource
+    template <class Predicate>
+    std::vector<Document> FindTopDocuments(const std::string& raw_query, Predicate predicate, std::pmr::memory_resource* resource) const;
+
     std::vector<Document> FindTopDocuments(const std::string& raw_query) const;
+
+    // The result is allocated from resource as well.
+    // Statistics, when given, replace the IDF of this server's own documents
+    template <class Predicate>
+    std::pmr::vector<Document> FindTopDocuments(const Query& query, Predicate predicate, std::pmr::memory_resource* resource,
+        const CorpusStatistics* statistics = nullptr) const;
+
+    Query ParseQuery(std::string_view text, std::pmr::memory_resource* resource) const;
+
+    static bool CompareByRelevance(const Document& lhs, const Document& rhs);
+
+    // Documents of one page of the ranked result, only top (page + 1) * page_size are ordered
+    template <class Predicate>
+    std::vector<Document> FindDocumentsPage(const std::string& raw_query, Predicate predicate, size_t page, size_t page_size) const;
+
+    std::vector<Document> FindDocumentsPage(const std::string& raw_query, DocumentStatus status, size_t page, size_t page_size) const;
+
+    std::vector<Document> FindDocumentsPage(const std::string& raw_query, size_t page, size_t page_size) const;
     
     inline int GetDocumentCount() const
     {
@@ -51,9 +99,9 @@ public:
     const std::map<std::string, double>& GetWordFrequencies(int document_id) const;
 
 private:
-    static bool IsValidWord(const std::string& word);
+    static bool IsValidWord(std::string_view word);
 
-    inline bool IsStopWord(const std::string& word) const
+    inline bool IsStopWord(std::string_view word) const
     {
         return stop_words_.count(word) > 0;
     }
@@ -61,16 +109,21 @@ private:
     std::vector<std::string> SplitIntoWordsNoStop(const std::string& text) const;
 
     static int ComputeAverageRating(const std::vector<int>& ratings);
-    double ComputeWordInverseDocumentFreq(const std::string& word) const;
-
-    struct Query;
-    Query ParseQuery(const std::string& text) const;
+    static double ComputeWordInverseDocumentFreq(int document_count, size_t word_document_count);
 
     struct QueryWord;
-    QueryWord ParseQueryWord(std::string text) const;
+    QueryWord ParseQueryWord(std::string_view text) const;
+
+    // Keeps only the documents [offset, offset + count) of the ranked order
+    static void SelectTopDocuments(std::pmr::vector<Document>& documents, size_t offset, size_t count);
+
+    template <class Predicate>
+    std::pmr::vector<Document> FindRankedDocuments(const Query& query, Predicate predicate, size_t offset, size_t count,
+        std::pmr::memory_resource* resource, const CorpusStatistics* statistics) const;
 
     template <class Predicate>
-    std::vector<Document> FindAllDocuments(const Query& query, Predicate predicate) const;
+    std::pmr::vector<Document> FindAllDocuments(const Query& query, Predicate predicate, std::pmr::memory_resource* resource,
+        const CorpusStatistics* statistics = nullptr) const;
 private:
     struct DocumentData
     {
@@ -80,20 +133,14 @@ private:
 
     struct QueryWord
     {
-        std::string data;
+        std::string_view data;
         bool is_minus;
         bool is_stop;
     };
 
-    struct Query
-    {
-        std::set<std::string> plus_words;
-        std::set<std::string> minus_words;
-    };
-
-    std::set<std::string> stop_words_;
+    std::set<std::string, std::less<>> stop_words_;
     std::map<int, std::map<std::string, double>> id_to_word_freqs_;
-    std::map<std::string, std::map<int, double>> word_to_document_freqs_;
+    std::map<std::string, std::map<int, double>, std::less<>> word_to_document_freqs_;
     std::map<int, DocumentData> documents_;
     std::set<int> documents_id_;
 };
@@ -102,21 +149,46 @@ private:
 template <class Predicate>
 std::vector<Document> SearchServer::FindTopDocuments(const std::string& raw_query, Predicate predicate) const
 {
-    Query query = ParseQuery(raw_query);
+    QueryArena arena;
+    return FindTopDocuments(raw_query, predicate, arena.Resource());
+}
 
-    auto matched_documents = FindAllDocuments(query, predicate);
+template <class Predicate>
+std::vector<Document> SearchServer::FindTopDocuments(const std::string& raw_query, Predicate predicate, std::pmr::memory_resource* resource) const
+{
+    const auto documents = FindTopDocuments(ParseQuery(raw_query, resource), predicate, resource);
+    return { documents.begin(), documents.end() };
+}
 
-    sort(matched_documents.begin(), matched_documents.end(),
-        [](const Document& lhs, const Document& rhs)
-        {
-            if (std::abs(lhs.relevance - rhs.relevance) < EPSILON)
-                return lhs.rating > rhs.rating;
-            else
-                return lhs.relevance > rhs.relevance;
-        });
+template <class Predicate>
+std::pmr::vector<Document> SearchServer::FindTopDocuments(const Query& query, Predicate predicate, std::pmr::memory_resource* resource,
+    const CorpusStatistics* statistics) const
+{
+    return FindRankedDocuments(query, predicate, 0, MAX_RESULT_DOCUMENT_COUNT, resource, statistics);
+}
 
-    if (matched_documents.size() > MAX_RESULT_DOCUMENT_COUNT)
-        matched_documents.resize(MAX_RESULT_DOCUMENT_COUNT);
+template <class Predicate>
+std::vector<Document> SearchServer::FindDocumentsPage(const std::string& raw_query, Predicate predicate, size_t page, size_t page_size) const
+{
+    if (page_size == 0)
+        throw std::invalid_argument("Page size must be positive");
+
+    // The first document of the page is past any result
+    if (page > std::numeric_limits<size_t>::max() / page_size)
+        return {};
+
+    QueryArena arena;
+    const auto documents = FindRankedDocuments(ParseQuery(raw_query, arena.Resource()), predicate, page * page_size, page_size,
+        arena.Resource(), nullptr);
+    return { documents.begin(), documents.end() };
+}
+
+template <class Predicate>
+std::pmr::vector<Document> SearchServer::FindRankedDocuments(const Query& query, Predicate predicate, size_t offset, size_t count,
+    std::pmr::memory_resource* resource, const CorpusStatistics* statistics) const
+{
+    auto matched_documents = FindAllDocuments(query, predicate, resource, statistics);
+    SelectTopDocuments(matched_documents, offset, count);
 
     return matched_documents;
 }
@@ -128,20 +200,32 @@ SearchServer::SearchServer(const StringContainer& stop_words)
     if (!std::all_of(set_stop_words.begin(), set_stop_words.end(), IsValidWord))
         throw std::invalid_argument("Stop word has forbidden symbols");
 
-    stop_words_ = set_stop_words;
+    stop_words_.insert(set_stop_words.begin(), set_stop_words.end());
 }
 
 template <class Predicate>
-std::vector<Document> SearchServer::FindAllDocuments(const Query& query, Predicate predicate) const
+std::pmr::vector<Document> SearchServer::FindAllDocuments(const Query& query, Predicate predicate, std::pmr::memory_resource* resource,
+    const CorpusStatistics* statistics) const
 {
-    std::map<int, double> document_to_relevance;
-    for (const std::string& word : query.plus_words)
+    std::pmr::map<int, double> document_to_relevance(resource);
+    size_t word_index = 0;
+    for (const std::string_view word : query.plus_words)
     {
-        if (word_to_document_freqs_.count(word) == 0)
+        const auto statistics_index = word_index++;
+        const auto word_freqs = word_to_document_freqs_.find(word);
+        if (word_freqs == word_to_document_freqs_.end())
             continue;
 
-        const double inverse_document_freq = ComputeWordInverseDocumentFreq(word);
-        for (const auto& [document_id, term_freq] : word_to_document_freqs_.at(word))
+        int document_count = GetDocumentCount();
+        size_t word_document_count = word_freqs->second.size();
+        if (statistics)
+        {
+            document_count = statistics->document_count;
+            word_document_count = statistics->word_document_count.at(statistics_index);
+        }
+
+        const double inverse_document_freq = ComputeWordInverseDocumentFreq(document_count, word_document_count);
+        for (const auto& [document_id, term_freq] : word_freqs->second)
         {
             const auto& [rating, status] = documents_.at(document_id);
             if (predicate(document_id, status, rating))
@@ -149,16 +233,18 @@ std::vector<Document> SearchServer::FindAllDocuments(const Query& query, Predica
         }
     }
 
-    for (const std::string& word : query.minus_words)
+    for (const std::string_view word : query.minus_words)
     {
-        if (word_to_document_freqs_.count(word) == 0)
+        const auto word_freqs = word_to_document_freqs_.find(word);
+        if (word_freqs == word_to_document_freqs_.end())
             continue;
 
-        for (const auto& [document_id, _] : word_to_document_freqs_.at(word))
+        for (const auto& [document_id, _] : word_freqs->second)
             document_to_relevance.erase(document_id);
     }
 
-    std::vector<Document> matched_documents;
+    std::pmr::vector<Document> matched_documents(resource);
+    matched_documents.reserve(document_to_relevance.size());
     for (const auto& [document_id, relevance] : document_to_relevance)
         matched_documents.push_back({ document_id, relevance, documents_.at(document_id).rating });
 
@@ -0,0 +1,92 @@
+#include "sharded_search_server.h"
+
+#include <functional>
+
+ShardedSearchServer::ShardedSearchServer(const std::string& stop_words_text, size_t shard_count)
+    : shards_(shard_count, SearchServer(stop_words_text)), pool_(shard_count > 0 ? shard_count - 1 : 0)
+{
+    CheckShardCount();
+}
+
+void ShardedSearchServer::AddDocument(int document_id, const std::string& document, DocumentStatus status, const std::vector<int>& ratings)
+{
+    // The shard rejects negative and already added ids, equal ids always map to the same shard
+    auto& shard = GetShard(document_id);
+    shard.AddDocument(document_id, document, status, ratings);
+    documents_id_.insert(document_id);
+
+    for (const auto& [word, _] : shard.GetWordFrequencies(document_id))
+        ++word_document_count_[word];
+}
+
+std::vector<Document> ShardedSearchServer::FindTopDocuments(const std::string& raw_query, const DocumentStatus status) const
+{
+    return FindTopDocuments(raw_query,
+        [status]([[maybe_unused]] int id, [[maybe_unused]] DocumentStatus status_to_compare, [[maybe_unused]] int rating)
+        {
+            return status == status_to_compare;
+        });
+}
+
+std::vector<Document> ShardedSearchServer::FindTopDocuments(const std::string& raw_query) const
+{
+    return FindTopDocuments(raw_query, DocumentStatus::ACTUAL);
+}
+
+std::tuple<std::vector<std::string>, DocumentStatus> ShardedSearchServer::MatchDocument(const std::string& raw_query, int document_id) const
+{
+    return GetShard(document_id).MatchDocument(raw_query, document_id);
+}
+
+void ShardedSearchServer::RemoveDocument(int document_id)
+{
+    if (documents_id_.count(document_id) == 0)
+        return;
+
+    auto& shard = GetShard(document_id);
+    for (const auto& [word, _] : shard.GetWordFrequencies(document_id))
+    {
+        const auto word_count = word_document_count_.find(word);
+        if (--word_count->second == 0)
+            word_document_count_.erase(word_count);
+    }
+
+    shard.RemoveDocument(document_id);
+    documents_id_.erase(document_id);
+}
+
+const std::map<std::string, double>& ShardedSearchServer::GetWordFrequencies(int document_id) const
+{
+    return GetShard(document_id).GetWordFrequencies(document_id);
+}
+
+void ShardedSearchServer::CheckShardCount() const
+{
+    if (shards_.empty())
+        throw std::invalid_argument("Shard count must be positive");
+}
+
+CorpusStatistics ShardedSearchServer::GetQueryStatistics(const SearchServer::Query& query, std::pmr::memory_resource* resource) const
+{
+    CorpusStatistics statistics(resource);
+    statistics.document_count = GetDocumentCount();
+    statistics.word_document_count.reserve(query.plus_words.size());
+
+    for (const std::string_view word : query.plus_words)
+    {
+        const auto word_count = word_document_count_.find(word);
+        statistics.word_document_count.push_back(word_count == word_document_count_.end() ? 0 : word_count->second);
+    }
+
+    return statistics;
+}
+
+SearchServer& ShardedSearchServer::GetShard(int document_id)
+{
+    return shards_[std::hash<int>{}(document_id) % shards_.size()];
+}
+
+const SearchServer& ShardedSearchServer::GetShard(int document_id) const
+{
+    return shards_[std::hash<int>{}(document_id) % shards_.size()];
+}
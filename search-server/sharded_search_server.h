@@ -0,0 +1,117 @@
+#pragma once
+#include "search_server.h"
+#include "thread_pool.h"
+
+#include <set>
+#include <vector>
+
+// Documents are hash-partitioned by id across several SearchServer shards.
+// Queries run on all shards concurrently with corpus-wide word statistics,
+// so relevance matches a single SearchServer holding all the documents.
+class ShardedSearchServer
+{
+public:
+    ShardedSearchServer(const std::string& stop_words_text, size_t shard_count);
+
+    template <class StringContainer>
+    ShardedSearchServer(const StringContainer& stop_words, size_t shard_count);
+
+    void AddDocument(int document_id, const std::string& document, DocumentStatus status, const std::vector<int>& ratings);
+
+    std::vector<Document> FindTopDocuments(const std::string& raw_query, const DocumentStatus status) const;
+
+    // The predicate is called from several threads at once
+    template <class Predicate>
+    std::vector<Document> FindTopDocuments(const std::string& raw_query, Predicate predicate) const;
+
+    std::vector<Document> FindTopDocuments(const std::string& raw_query) const;
+
+    inline int GetDocumentCount() const
+    {
+        return static_cast<int>(documents_id_.size());
+    }
+
+    inline size_t GetShardCount() const
+    {
+        return shards_.size();
+    }
+
+    std::tuple<std::vector<std::string>, DocumentStatus> MatchDocument(const std::string& raw_query, int document_id) const;
+
+    inline std::set<int>::const_iterator begin() const
+    {
+        return documents_id_.cbegin();
+    }
+
+    inline std::set<int>::const_iterator end() const
+    {
+        return documents_id_.cend();
+    }
+
+    void RemoveDocument(int document_id);
+
+    const std::map<std::string, double>& GetWordFrequencies(int document_id) const;
+
+private:
+    void CheckShardCount() const;
+
+    CorpusStatistics GetQueryStatistics(const SearchServer::Query& query, std::pmr::memory_resource* resource) const;
+
+    SearchServer& GetShard(int document_id);
+    const SearchServer& GetShard(int document_id) const;
+private:
+    std::vector<SearchServer> shards_;
+    std::set<int> documents_id_;
+    // Number of documents of all shards containing the word
+    std::map<std::string, int, std::less<>> word_document_count_;
+
+    // The calling thread searches the first shard, the pool the rest
+    mutable ThreadPool pool_;
+};
+
+
+template <class StringContainer>
+ShardedSearchServer::ShardedSearchServer(const StringContainer& stop_words, size_t shard_count)
+    : shards_(shard_count, SearchServer(stop_words)), pool_(shard_count > 0 ? shard_count - 1 : 0)
+{
+    CheckShardCount();
+}
+
+template <class Predicate>
+std::vector<Document> ShardedSearchServer::FindTopDocuments(const std::string& raw_query, Predicate predicate) const
+{
+    QueryArena arena;
+    // All shards share the stop words, so the query is parsed once
+    const auto query = shards_.front().ParseQuery(raw_query, arena.Resource());
+    const auto statistics = GetQueryStatistics(query, arena.Resource());
+
+    // Every shard writes its top documents into its own slot, query and statistics are shared read-only
+    const size_t slot_size = MAX_RESULT_DOCUMENT_COUNT;
+    std::pmr::vector<Document> matched_documents(shards_.size() * slot_size, arena.Resource());
+    std::pmr::vector<size_t> shard_document_counts(shards_.size(), arena.Resource());
+
+    auto search_shard = [&](size_t shard_index)
+    {
+        // monotonic_buffer_resource is not thread-safe, so each shard allocates from the arena of its own thread
+        QueryArena shard_arena;
+        const auto shard_documents = shards_[shard_index].FindTopDocuments(query, predicate, shard_arena.Resource(), &statistics);
+
+        std::copy(shard_documents.begin(), shard_documents.end(), matched_documents.begin() + shard_index * slot_size);
+        shard_document_counts[shard_index] = shard_documents.size();
+    };
+    pool_.ParallelFor(shards_.size(), search_shard);
+
+    // Global top documents are among the top documents of their shards
+    auto merged_end = matched_documents.begin();
+    for (size_t shard_index = 0; shard_index < shards_.size(); ++shard_index)
+    {
+        const auto slot_begin = matched_documents.begin() + shard_index * slot_size;
+        merged_end = std::copy(slot_begin, slot_begin + shard_document_counts[shard_index], merged_end);
+    }
+    matched_documents.erase(merged_end, matched_documents.end());
+
+    const auto last = matched_documents.begin() + std::min(matched_documents.size(), static_cast<size_t>(MAX_RESULT_DOCUMENT_COUNT));
+    std::partial_sort(matched_documents.begin(), last, matched_documents.end(), SearchServer::CompareByRelevance);
+
+    return { matched_documents.begin(), last };
+}
@@ -22,4 +22,22 @@ std::vector<std::string> SplitIntoWords(const std::string& text)
         words.push_back(word);
 
     return words;
-}
\ No newline at end of file
+}
+
+std::pmr::vector<std::string_view> SplitIntoWords(std::string_view text, std::pmr::memory_resource* resource)
+{
+    std::pmr::vector<std::string_view> words(resource);
+    while (!text.empty())
+    {
+        const auto space = text.find(' ');
+        const auto word = text.substr(0, space);
+        if (!word.empty())
+            words.push_back(word);
+
+        if (space == std::string_view::npos)
+            break;
+        text.remove_prefix(space + 1);
+    }
+
+    return words;
+}
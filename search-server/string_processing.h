@@ -2,9 +2,14 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <string_view>
+#include <memory_resource>
 
 std::vector<std::string> SplitIntoWords(const std::string& text);
 
+// Words are views into text, only the vector itself is allocated from resource
+std::pmr::vector<std::string_view> SplitIntoWords(std::string_view text, std::pmr::memory_resource* resource);
+
 template <class StringContainer>
 std::set<std::string> MakeUniqueNonEmptyStrings(const StringContainer& strings) 
 {
@@ -0,0 +1,157 @@
+// Build from search-server/:
+// g++ -std=c++17 -I. tests/test_paginator.cpp search_server.cpp string_processing.cpp query_arena.cpp document.cpp
+#include "search_server.h"
+#include "paginator.h"
+
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    template <class Container>
+    void CheckPagesCoverRange(const Container& items, size_t page_size)
+    {
+        const auto pages = Paginate(items, page_size);
+        assert(pages.size() == (items.size() + page_size - 1) / page_size);
+
+        std::vector<int> walked;
+        size_t page_index = 0;
+        for (const auto page : pages)
+        {
+            assert(page.size() > 0 && page.size() <= page_size);
+
+            const auto indexed_page = pages[page_index++];
+            assert(std::equal(page.begin(), page.end(), indexed_page.begin(), indexed_page.end()));
+
+            walked.insert(walked.end(), page.begin(), page.end());
+        }
+
+        assert(page_index == pages.size());
+        assert(std::equal(walked.begin(), walked.end(), items.begin(), items.end()));
+        assert(pages[pages.size()].size() == 0);
+    }
+}
+
+void TestPaginatorWalksRandomAccessAndListRanges()
+{
+    for (const size_t item_count : { 0, 1, 6, 7, 20 })
+    {
+        std::vector<int> vector_items(item_count);
+        std::iota(vector_items.begin(), vector_items.end(), 0);
+        const std::list<int> list_items(vector_items.begin(), vector_items.end());
+
+        for (const size_t page_size : { 1, 3, 7, 25 })
+        {
+            CheckPagesCoverRange(vector_items, page_size);
+            CheckPagesCoverRange(list_items, page_size);
+        }
+    }
+}
+
+void TestPaginatorPastTheEndPageIsEmptyOnOverflow()
+{
+    const std::vector<int> vector_items(10);
+    const std::list<int> list_items(10);
+
+    const size_t overflowing_index = std::numeric_limits<size_t>::max() / 3 + 1;
+    assert(Paginate(vector_items, 3)[overflowing_index].size() == 0);
+    assert(Paginate(list_items, 3)[overflowing_index].size() == 0);
+    assert(Paginate(vector_items, 3)[std::numeric_limits<size_t>::max()].size() == 0);
+}
+
+void TestFindDocumentsPagePartitionsTiedResults()
+{
+    using namespace std::string_literals;
+
+    // Every document has the same relevance, ratings tie in thirds
+    const int document_count = 200;
+    SearchServer search_server("and"s);
+    for (int id = 0; id < document_count; ++id)
+        search_server.AddDocument(id, "cat dog"s, DocumentStatus::ACTUAL, { id % 3 });
+
+    const size_t page_size = 7;
+    std::vector<Document> walked;
+    for (size_t page = 0;; ++page)
+    {
+        const auto documents = search_server.FindDocumentsPage("cat"s, page, page_size);
+        if (documents.empty())
+            break;
+
+        assert(documents.size() <= page_size);
+        walked.insert(walked.end(), documents.begin(), documents.end());
+    }
+
+    assert(walked.size() == document_count);
+
+    std::set<int> ids;
+    for (const auto& document : walked)
+        ids.insert(document.id);
+    assert(ids.size() == document_count);
+
+    assert(std::is_sorted(walked.begin(), walked.end(), SearchServer::CompareByRelevance));
+
+    const auto top = search_server.FindTopDocuments("cat"s);
+    for (size_t i = 0; i < top.size(); ++i)
+        assert(top[i].id == walked[i].id);
+}
+
+void TestFindDocumentsPageOverflowIsEmpty()
+{
+    using namespace std::string_literals;
+
+    SearchServer search_server("and"s);
+    for (int id = 0; id < 10; ++id)
+        search_server.AddDocument(id, "cat dog"s, DocumentStatus::ACTUAL, { id });
+
+    assert(search_server.FindDocumentsPage("cat"s, std::numeric_limits<size_t>::max() / 2 + 1, 2).empty());
+    assert(search_server.FindDocumentsPage("cat"s, std::numeric_limits<size_t>::max(), 3).empty());
+    assert(search_server.FindDocumentsPage("cat"s, 4, 2).size() == 2);
+    assert(search_server.FindDocumentsPage("cat"s, 5, 2).empty());
+}
+
+void TestZeroPageSizeThrows()
+{
+    using namespace std::string_literals;
+
+    SearchServer search_server("and"s);
+    search_server.AddDocument(1, "cat dog"s, DocumentStatus::ACTUAL, { 1 });
+
+    const std::vector<int> items(5);
+    bool paginator_thrown = false;
+    try
+    {
+        Paginate(items, 0);
+    }
+    catch (const std::invalid_argument&)
+    {
+        paginator_thrown = true;
+    }
+
+    bool search_thrown = false;
+    try
+    {
+        search_server.FindDocumentsPage("cat"s, 0, 0);
+    }
+    catch (const std::invalid_argument&)
+    {
+        search_thrown = true;
+    }
+
+    assert(paginator_thrown && search_thrown);
+}
+
+int main()
+{
+    TestPaginatorWalksRandomAccessAndListRanges();
+    TestPaginatorPastTheEndPageIsEmptyOnOverflow();
+    TestFindDocumentsPagePartitionsTiedResults();
+    TestFindDocumentsPageOverflowIsEmpty();
+    TestZeroPageSizeThrows();
+    std::cout << "Paginator tests passed" << std::endl;
+}
@@ -0,0 +1,118 @@
+// Build from search-server/:
+// g++ -std=c++17 -I. tests/test_query_arena.cpp search_server.cpp string_processing.cpp query_arena.cpp document.cpp
+#include "search_server.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace
+{
+    size_t allocation_count = 0;
+
+    void* CountedAllocate(size_t size, size_t alignment)
+    {
+        ++allocation_count;
+        void* p = alignment > alignof(std::max_align_t)
+            ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+            : std::malloc(size ? size : 1);
+        if (!p)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    template <class Function>
+    size_t CountAllocations(Function function)
+    {
+        const auto before = allocation_count;
+        function();
+        return allocation_count - before;
+    }
+}
+
+void* operator new(size_t size)
+{
+    return CountedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return CountedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void TestQueryAllocationCountIsConstant()
+{
+    using namespace std::string_literals;
+
+    // 20000 matches make the relevance map far larger than the initial 64 KiB arena
+    const int document_count = 20000;
+    SearchServer search_server("and with"s);
+    for (int id = 0; id < document_count; ++id)
+        search_server.AddDocument(id, "funny pet and rat number"s + std::to_string(id), DocumentStatus::ACTUAL, { id % 10 });
+
+    const auto broad_query = "funny pet -nothing"s;
+    const auto narrow_query = "number42 -nothing"s;
+
+    // Grows the arena to the working set of the broad query
+    assert(search_server.FindTopDocuments(broad_query).size() == MAX_RESULT_DOCUMENT_COUNT);
+
+    // Only the returned vector is allocated, however many documents match
+    for (int i = 0; i < 2; ++i)
+    {
+        assert(CountAllocations([&] { search_server.FindTopDocuments(broad_query); }) == 1);
+        assert(CountAllocations([&] { search_server.FindTopDocuments(narrow_query); }) == 1);
+        assert(CountAllocations([&] { search_server.FindDocumentsPage(broad_query, 1000, 10); }) == 1);
+    }
+}
+
+void TestArenaRetainsAtMostTheCap()
+{
+    using namespace std::string_literals;
+
+    // The relevance map and matched documents of 200000 matches exceed the retained cap
+    const int document_count = 200000;
+    static_assert(document_count * sizeof(Document) > QueryArena::MAX_RETAINED_SIZE / 2);
+    SearchServer search_server("and with"s);
+    for (int id = 0; id < document_count; ++id)
+        search_server.AddDocument(id, (id % 10 ? "funny pet"s : "funny cat"s), DocumentStatus::ACTUAL, { id % 10 });
+
+    const auto outlier_query = "funny"s;
+    const auto broad_query = "cat"s;
+
+    assert(search_server.FindTopDocuments(outlier_query).size() == MAX_RESULT_DOCUMENT_COUNT);
+
+    // The outlier keeps paying for its overflow, the buffer is not grown past the cap
+    for (int i = 0; i < 2; ++i)
+        assert(CountAllocations([&] { search_server.FindTopDocuments(outlier_query); }) > 1);
+
+    // Queries that fit into the capped buffer still allocate only the result
+    assert(CountAllocations([&] { search_server.FindTopDocuments(broad_query); }) == 1);
+}
+
+int main()
+{
+    TestQueryAllocationCountIsConstant();
+    TestArenaRetainsAtMostTheCap();
+    std::cout << "Query arena tests passed" << std::endl;
+}
@@ -0,0 +1,157 @@
+// Build from search-server/:
+// g++ -std=c++17 -pthread -I. tests/test_request_queue.cpp request_queue.cpp search_server.cpp string_processing.cpp query_arena.cpp document.cpp
+#include "request_queue.h"
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    SearchServer MakeSearchServer()
+    {
+        using namespace std::string_literals;
+
+        SearchServer search_server("and with"s);
+        search_server.AddDocument(1, "curly cat"s, DocumentStatus::ACTUAL, { 1 });
+        return search_server;
+    }
+}
+
+void TestRequestsExpireWithWindow()
+{
+    using namespace std::chrono_literals;
+
+    const auto search_server = MakeSearchServer();
+    RequestQueue queue(search_server, 400ms, 4);
+    const auto start = RequestQueue::Clock::now();
+
+    for (int i = 0; i < 3; ++i)
+        assert(queue.AddFindRequest("dog").empty());
+    for (int i = 0; i < 2; ++i)
+        assert(queue.AddFindRequest("curly").size() == 1);
+
+    assert(queue.GetRequestCount() == 5);
+    assert(queue.GetNoResultRequests() == 3);
+    assert(queue.GetAverageResultCount() == 0.4);
+    assert(queue.GetMedianLatency() <= queue.GetP99Latency());
+
+    // Third bucket, the first one is still inside the window
+    std::this_thread::sleep_until(start + 250ms);
+    queue.AddFindRequest("dog");
+    assert(queue.GetRequestCount() == 6);
+    assert(queue.GetNoResultRequests() == 4);
+
+    // Fifth bucket, the first one has left the window
+    std::this_thread::sleep_until(start + 450ms);
+    assert(queue.GetRequestCount() == 1);
+    assert(queue.GetNoResultRequests() == 1);
+
+    std::this_thread::sleep_until(start + 750ms);
+    assert(queue.GetRequestCount() == 0);
+    assert(queue.GetNoResultRequests() == 0);
+    assert(queue.GetAverageResultCount() == 0.0);
+    assert(queue.GetP99Latency() == std::chrono::microseconds::zero());
+
+    queue.AddFindRequest("curly");
+    assert(queue.GetRequestCount() == 1);
+    assert(queue.GetNoResultRequests() == 0);
+}
+
+void TestLatencyBinBounds()
+{
+    using std::chrono::microseconds;
+
+    // Below two sub-bin octaves every microsecond has its own bin
+    for (int64_t micros = 0; micros < 16; ++micros)
+    {
+        assert(RequestQueue::GetLatencyBin(microseconds(micros)) == static_cast<size_t>(micros));
+        assert(RequestQueue::GetLatencyBinUpperBound(static_cast<size_t>(micros)) == micros);
+    }
+
+    const auto overflow_bin = RequestQueue::LATENCY_BIN_COUNT - 1;
+    for (size_t bin = 16; bin < overflow_bin; ++bin)
+    {
+        const auto lower = RequestQueue::GetLatencyBinUpperBound(bin - 1) + 1;
+        const auto upper = RequestQueue::GetLatencyBinUpperBound(bin);
+        assert(lower <= upper);
+        assert(RequestQueue::GetLatencyBin(microseconds(lower)) == bin);
+        assert(RequestQueue::GetLatencyBin(microseconds(upper)) == bin);
+        assert((upper - lower) * 8 < lower);
+    }
+
+    const int64_t histogram_range = int64_t{ 1 } << RequestQueue::MAX_LATENCY_BITS;
+    assert(RequestQueue::GetLatencyBinUpperBound(overflow_bin - 1) == histogram_range - 1);
+    assert(RequestQueue::GetLatencyBin(microseconds(histogram_range - 1)) == overflow_bin - 1);
+    assert(RequestQueue::GetLatencyBin(microseconds(histogram_range)) == overflow_bin);
+    assert(RequestQueue::GetLatencyBin(std::chrono::hours(1000)) == overflow_bin);
+    assert(RequestQueue::GetLatencyBinUpperBound(overflow_bin) == microseconds::max().count());
+}
+
+void TestZeroBucketCountThrows()
+{
+    const auto search_server = MakeSearchServer();
+
+    bool thrown = false;
+    try
+    {
+        RequestQueue queue(search_server, std::chrono::minutes(1), 0);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+
+    assert(thrown);
+}
+
+void TestConcurrentWritersAndReader()
+{
+    const auto search_server = MakeSearchServer();
+    RequestQueue queue(search_server);
+
+    const int writer_count = 8;
+    const int requests_per_writer = 2000;
+
+    std::atomic<bool> writing = true;
+    std::thread reader([&]
+        {
+            while (writing.load())
+            {
+                assert(queue.GetRequestCount() <= writer_count * requests_per_writer * 2);
+                assert(queue.GetNoResultRequests() <= writer_count * requests_per_writer);
+                queue.GetP99Latency();
+            }
+        });
+
+    std::vector<std::thread> writers;
+    for (int writer = 0; writer < writer_count; ++writer)
+        writers.emplace_back([&]
+            {
+                for (int i = 0; i < requests_per_writer; ++i)
+                {
+                    queue.AddFindRequest("dog");
+                    queue.AddFindRequest("curly");
+                }
+            });
+
+    for (auto& writer : writers)
+        writer.join();
+    writing = false;
+    reader.join();
+
+    assert(queue.GetRequestCount() == writer_count * requests_per_writer * 2);
+    assert(queue.GetNoResultRequests() == writer_count * requests_per_writer);
+    assert(queue.GetAverageResultCount() == 0.5);
+}
+
+int main()
+{
+    TestRequestsExpireWithWindow();
+    TestLatencyBinBounds();
+    TestZeroBucketCountThrows();
+    TestConcurrentWritersAndReader();
+    std::cout << "Request queue tests passed" << std::endl;
+}
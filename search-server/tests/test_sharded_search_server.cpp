@@ -0,0 +1,197 @@
+// Build from search-server/:
+// g++ -std=c++17 -pthread -I. tests/test_sharded_search_server.cpp sharded_search_server.cpp thread_pool.cpp remove_duplicates.cpp search_server.cpp string_processing.cpp query_arena.cpp document.cpp
+#include "sharded_search_server.h"
+#include "remove_duplicates.h"
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const std::string STOP_WORDS = "and with";
+    const std::vector<std::string> VOCABULARY = {
+        "cat", "dog", "rat", "curly", "funny", "nasty", "pet", "hair", "big", "small", "and", "with"
+    };
+
+    std::string MakeText(std::mt19937& generator, int max_word_count)
+    {
+        std::string text;
+        const int word_count = 1 + static_cast<int>(generator() % max_word_count);
+        for (int i = 0; i < word_count; ++i)
+            text += VOCABULARY[generator() % VOCABULARY.size()] + " ";
+        return text;
+    }
+
+    std::string MakeQuery(std::mt19937& generator)
+    {
+        std::string query = MakeText(generator, 4);
+        if (generator() % 2)
+            query += "-" + VOCABULARY[generator() % VOCABULARY.size()];
+        return query;
+    }
+
+    void AssertEqualDocuments(const std::vector<Document>& expected, const std::vector<Document>& actual)
+    {
+        assert(expected.size() == actual.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            assert(expected[i].id == actual[i].id);
+            assert(expected[i].relevance == actual[i].relevance);
+            assert(expected[i].rating == actual[i].rating);
+        }
+    }
+
+    void AssertEqualServers(const SearchServer& single, const ShardedSearchServer& sharded, std::mt19937& generator)
+    {
+        assert(single.GetDocumentCount() == sharded.GetDocumentCount());
+        assert(std::equal(single.begin(), single.end(), sharded.begin(), sharded.end()));
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const auto query = MakeQuery(generator);
+            AssertEqualDocuments(single.FindTopDocuments(query), sharded.FindTopDocuments(query));
+            AssertEqualDocuments(single.FindTopDocuments(query, DocumentStatus::BANNED),
+                sharded.FindTopDocuments(query, DocumentStatus::BANNED));
+
+            const auto even_rating = [](int, DocumentStatus, int rating) { return rating % 2 == 0; };
+            AssertEqualDocuments(single.FindTopDocuments(query, even_rating), sharded.FindTopDocuments(query, even_rating));
+        }
+
+        for (const int document_id : single)
+        {
+            assert(single.MatchDocument("cat funny -rat", document_id) == sharded.MatchDocument("cat funny -rat", document_id));
+            assert(single.GetWordFrequencies(document_id) == sharded.GetWordFrequencies(document_id));
+        }
+    }
+}
+
+void TestShardedSearchMatchesSingleServer()
+{
+    std::mt19937 generator(42);
+    for (size_t shard_count = 1; shard_count <= 5; ++shard_count)
+    {
+        SearchServer single(STOP_WORDS);
+        ShardedSearchServer sharded(STOP_WORDS, shard_count);
+        assert(sharded.GetShardCount() == shard_count);
+
+        for (int document_id = 0; document_id < 400; ++document_id)
+        {
+            const auto text = MakeText(generator, 6);
+            const auto status = static_cast<DocumentStatus>(generator() % 3);
+            const std::vector<int> ratings = { static_cast<int>(generator() % 10), static_cast<int>(generator() % 10) };
+
+            single.AddDocument(document_id, text, status, ratings);
+            sharded.AddDocument(document_id, text, status, ratings);
+        }
+        AssertEqualServers(single, sharded, generator);
+
+        for (int document_id = 0; document_id < 400; document_id += 7)
+        {
+            single.RemoveDocument(document_id);
+            sharded.RemoveDocument(document_id);
+        }
+        AssertEqualServers(single, sharded, generator);
+
+        // RemoveDuplicates reports every duplicate it finds
+        std::ostringstream discarded_output;
+        auto* const cout_buffer = std::cout.rdbuf(discarded_output.rdbuf());
+        const auto single_duplicates = FindDuplicates(single);
+        assert(single_duplicates == FindDuplicates(sharded));
+        RemoveDuplicates(single);
+        RemoveDuplicates(sharded);
+        std::cout.rdbuf(cout_buffer);
+
+        assert(!single_duplicates.empty());
+        AssertEqualServers(single, sharded, generator);
+    }
+}
+
+void TestShardedSearchRejectsDuplicateIds()
+{
+    ShardedSearchServer sharded(STOP_WORDS, 3);
+    sharded.AddDocument(5, "cat", DocumentStatus::ACTUAL, { 1 });
+
+    bool thrown = false;
+    try
+    {
+        sharded.AddDocument(5, "dog", DocumentStatus::ACTUAL, { 1 });
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+
+    assert(thrown);
+    assert(sharded.GetDocumentCount() == 1);
+}
+
+void TestConcurrentQueriesMatchSingleServer()
+{
+    std::mt19937 generator(7);
+    SearchServer single(STOP_WORDS);
+    ShardedSearchServer sharded(STOP_WORDS, 4);
+    for (int document_id = 0; document_id < 1000; ++document_id)
+    {
+        const auto text = MakeText(generator, 6);
+        single.AddDocument(document_id, text, DocumentStatus::ACTUAL, { document_id % 7 });
+        sharded.AddDocument(document_id, text, DocumentStatus::ACTUAL, { document_id % 7 });
+    }
+
+    std::vector<std::string> queries;
+    for (int i = 0; i < 50; ++i)
+        queries.push_back(MakeQuery(generator));
+
+    // Several callers share the shard worker pool
+    std::vector<std::thread> clients;
+    for (int client = 0; client < 4; ++client)
+        clients.emplace_back([&]
+            {
+                for (int round = 0; round < 5; ++round)
+                    for (const auto& query : queries)
+                        AssertEqualDocuments(single.FindTopDocuments(query), sharded.FindTopDocuments(query));
+            });
+
+    for (auto& client : clients)
+        client.join();
+}
+
+void TestShardExceptionReachesCaller()
+{
+    ShardedSearchServer sharded(STOP_WORDS, 4);
+    for (int document_id = 0; document_id < 40; ++document_id)
+        sharded.AddDocument(document_id, "cat", DocumentStatus::ACTUAL, { 1 });
+
+    bool thrown = false;
+    try
+    {
+        sharded.FindTopDocuments("cat",
+            [](int document_id, DocumentStatus, int)
+            {
+                if (document_id == 39)
+                    throw std::runtime_error("predicate failed");
+                return true;
+            });
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    assert(thrown);
+    assert(sharded.FindTopDocuments("cat").size() == MAX_RESULT_DOCUMENT_COUNT);
+}
+
+int main()
+{
+    TestShardedSearchMatchesSingleServer();
+    TestShardedSearchRejectsDuplicateIds();
+    TestConcurrentQueriesMatchSingleServer();
+    TestShardExceptionReachesCaller();
+    std::cout << "Sharded search server tests passed" << std::endl;
+}
@@ -0,0 +1,98 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(size_t thread_count)
+{
+    threads_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+        threads_.emplace_back([this] { WorkerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    has_jobs_.notify_all();
+
+    for (auto& thread : threads_)
+        thread.join();
+}
+
+void ThreadPool::RunBatch(size_t count, void* task, TaskRunner runner)
+{
+    if (count == 0)
+        return;
+
+    Batch batch{ task, runner, count, nullptr, {} };
+    if (count > 1)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            for (size_t index = 1; index < count; ++index)
+                jobs_.push_back({ &batch, index });
+        }
+        has_jobs_.notify_all();
+    }
+
+    RunJob({ &batch, 0 });
+
+    // Without workers the caller runs the queued jobs itself
+    std::unique_lock lock(mutex_);
+    while (batch.remaining > 0)
+    {
+        if (threads_.empty() && !jobs_.empty())
+        {
+            const auto job = jobs_.front();
+            jobs_.pop_front();
+            lock.unlock();
+            RunJob(job);
+            lock.lock();
+            continue;
+        }
+
+        batch.done.wait(lock);
+    }
+
+    if (batch.error)
+        std::rethrow_exception(batch.error);
+}
+
+void ThreadPool::RunJob(const Job& job)
+{
+    std::exception_ptr error;
+    try
+    {
+        job.batch->runner(job.batch->task, job.index);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    std::lock_guard lock(mutex_);
+    if (error && !job.batch->error)
+        job.batch->error = error;
+
+    // The caller may destroy the batch as soon as it sees the last job done
+    if (--job.batch->remaining == 0)
+        job.batch->done.notify_one();
+}
+
+void ThreadPool::WorkerLoop()
+{
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        has_jobs_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty())
+            return;
+
+        const auto job = jobs_.front();
+        jobs_.pop_front();
+
+        lock.unlock();
+        RunJob(job);
+        lock.lock();
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for fan-out of one call across several tasks.
+// Workers live as long as the pool, so their thread-local state stays warm between calls.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Runs task(0) .. task(count - 1) and returns when all of them are done.
+    // Index 0 runs on the calling thread, the first exception thrown by a task is rethrown
+    template <class Task>
+    void ParallelFor(size_t count, Task& task)
+    {
+        RunBatch(count, &task,
+            [](void* erased_task, size_t index)
+            {
+                (*static_cast<Task*>(erased_task))(index);
+            });
+    }
+
+    inline size_t GetThreadCount() const
+    {
+        return threads_.size();
+    }
+private:
+    using TaskRunner = void (*)(void* task, size_t index);
+
+    struct Batch
+    {
+        void* task;
+        TaskRunner runner;
+        size_t remaining;
+        std::exception_ptr error;
+        std::condition_variable done;
+    };
+
+    struct Job
+    {
+        Batch* batch;
+        size_t index;
+    };
+
+    void RunBatch(size_t count, void* task, TaskRunner runner);
+    void RunJob(const Job& job);
+    void WorkerLoop();
+private:
+    std::mutex mutex_;
+    std::condition_variable has_jobs_;
+    std::deque<Job> jobs_;
+    bool stopping_ = false;
+
+    std::vector<std::thread> threads_;
+};